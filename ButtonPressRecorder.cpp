@@ -87,6 +87,11 @@ void ButtonPressRecorder::startPlayback()
   }
 }
 
+void ButtonPressRecorder::stopPlayback()
+{
+  playbackHeader = -1;
+}
+
 int ButtonPressRecorder::playback()
 {
   if (recording) return -1;  
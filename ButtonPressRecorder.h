@@ -46,6 +46,7 @@ public:
   int countRecords();
 
   void startPlayback();
+  void stopPlayback();
   int playback();
 
   bool continuousPlayback;
@@ -0,0 +1,93 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef FEATUREPOLICY_H
+#define FEATUREPOLICY_H
+
+#include "Arduino.h"
+
+/**
+ * Feature policies select at compile time which extra functions are built
+ * into the controller. Disabled features are removed from the poll loop
+ * entirely instead of being skipped at runtime.
+ **/
+
+struct FullFeatures {
+  static const bool autofire = true;
+  static const bool recorder = true;
+  static const bool macro = true;
+  static const bool logoEmulation = true;
+  static const bool debug = true;
+};
+
+struct PassthroughFeatures {
+  static const bool autofire = false;
+  static const bool recorder = false;
+  static const bool macro = false;
+  static const bool logoEmulation = false;
+  static const bool debug = false;
+};
+
+/** Picks Enabled or Disabled as the type of a feature's member **/
+template <bool enabled, class Enabled, class Disabled>
+struct FeatureType {
+  typedef Enabled Type;
+};
+
+template <class Enabled, class Disabled>
+struct FeatureType<false, Enabled, Disabled> {
+  typedef Disabled Type;
+};
+
+/** Stand-in for ButtonPressRecorder without a tape **/
+class NoRecorder {
+public:
+  bool continuousPlayback;
+
+  NoRecorder() { continuousPlayback = false; }
+  bool isIdle() { return true; }
+  void startRecording() {}
+  bool record(int) { return false; }
+  bool isRecording() { return false; }
+  void endRecording() {}
+  bool hasRecord() { return false; }
+  int countRecords() { return 0; }
+  void startPlayback() {}
+  void stopPlayback() {}
+  int playback() { return -1; }
+};
+
+/** Stand-in for MacroInterpreter without loop stack **/
+class NoMacro {
+public:
+  NoMacro(const uint8_t*, uint8_t) {}
+  void start() {}
+  void stop() {}
+  bool isRunning() { return false; }
+  uint16_t step() { return 0; }
+};
+
+#endif // FEATUREPOLICY_H
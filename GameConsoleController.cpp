@@ -25,35 +25,418 @@
  */
 
 #include "GameConsoleController.h"
+#include "MemoryMonitor.h"
+#include <Arduino_DebugUtils.h>
 
-void GameConsoleController::setup()
+char* regularButtonIdentifier[] = { "B", "Y", "Select", "Start", "Up", "Down", "Left", "Right", "A", "X", "L", "R", "Logo (emulated)" };
+char* switchedButtonIdentifier[] = { "A", "Y", "Select", "Start", "Up", "Down", "Left", "Right", "B", "X", "L", "R", "Logo (emulated)" };
+
+const uint8_t macroScript[] PROGMEM = { MACRO_SCRIPT };
+
+static_assert(sizeof(macroScript) < 256, "MACRO_SCRIPT exceeds 255 bytes");
+static_assert(STICK_EMULATION == STICK_OFF || OUTPUT_BACKEND == OUTPUT_XINPUT, "STICK_EMULATION requires OUTPUT_XINPUT, the other backends have no stick");
+static_assert(sizeof(ButtonPressRecorder) <= RAM_BUDGET_RECORDER, "ButtonPressRecorder exceeds its RAM budget");
+static_assert(sizeof(GameConsoleController<FullFeatures>) <= RAM_BUDGET_CONTROLLER, "GameConsoleController exceeds its RAM budget");
+
+template <class Features>
+GameConsoleController<Features>::GameConsoleController(int switchedAB) : socd(SOCD_MODE), stick(STICK_CURVE, STICK_RAMP_TIME), macro(macroScript, sizeof(macroScript))
 {
+  switchAB = switchedAB;
+  inputChanged = false;
+  inputPad = 0;
+  sentPad = 0;
+  startupState = STARTUP_WAITING;
+  startupTime = 0;
+  padPresent = false;
+  padAnswered = false;
+  padDebounce = 0;
+}
+
+template <class Features>
+void GameConsoleController<Features>::setup()
+{
+  output.begin();
+
+  #if OUTPUT_BACKEND == OUTPUT_XINPUT && !defined(USB_XINPUT)
+    startupState = STARTUP_READY;  // debug build, no host to wait for
+  #endif
 }
 
-void GameConsoleController::preFetch()
+template <class Features>
+void GameConsoleController<Features>::fetch()
 {
 }
 
-void GameConsoleController::fetch()
+template <class Features>
+void GameConsoleController<Features>::updateButtons(uint16_t pressed)
 {
+  if (!buttonTracking)
+  {
+    /** Passthrough: the read mask is sent as is **/
+    inputChanged = pressed != inputPad;
+    inputPad = pressed;
+    return;
+  }
+
+  inputChanged = false;
+  for (int id = 0; id < SNES_BTN_NUM; id++) {
+    button[id].updateInput(pressed & bit(id));
+    inputChanged |= button[id].changed;
+    if (Features::debug && button[id].changed && !deactivated && recorder.isIdle())
+    {
+      char* buttonLabel = switchAB ? switchedButtonIdentifier[id] : regularButtonIdentifier[id];
+      DEBUG_DEBUG("%s Pressed: %i", buttonLabel, button[id].pressed);
+      DEBUG_DEBUG("%s Released: %i", buttonLabel, button[id].released);
+      //DEBUG_DEBUG("%s Held: %i", buttonLabel, button[id].held);
+      DEBUG_DEBUG("%s Duration: %i", buttonLabel, button[id].duration);
+      DEBUG_DEBUG("%s Clicks: %i", buttonLabel, button[id].clicks);
+    }
+  }
 }
 
-void GameConsoleController::postFetch()
+template <class Features>
+bool GameConsoleController<Features>::isHostConnected()
 {
+  return startupState != STARTUP_WAITING;
 }
 
-ControllerButton GameConsoleController::get(int id)
+template <class Features>
+void GameConsoleController<Features>::handleStartup()
 {
+  switch (startupState)
+  {
+    case STARTUP_WAITING:
+      if (!output.connected()) return;
+      startupState = STARTUP_GREETING;
+      startupTime = millis();
+      break;
+    case STARTUP_GREETING:
+      uint8_t phase = (millis() - startupTime) / STARTUP_BLINK_TIME;
+      if (phase >= STARTUP_BLINKS) startupState = STARTUP_READY;
+      #ifdef LED_BUILTIN_RX
+        digitalWrite(LED_BUILTIN_RX, (phase & 1) ? HIGH : LOW);
+      #endif
+      break;
+  }
 }
 
-void GameConsoleController::set(int id, ControllerButton buttonUpdate)
+template <class Features>
+void GameConsoleController<Features>::preFetch()
 {
+  if (startupState != STARTUP_READY)
+  {
+    handleStartup();
+    return;
+  }
+
+  #ifdef LED_BUILTIN_RX && LED_BUILTIN_TX
+    if (Features::recorder) digitalWrite(LED_BUILTIN_RX, !recorder.isRecording() ? HIGH : LOW);
+    if (modifications) digitalWrite(LED_BUILTIN_TX, !deactivated ? HIGH : LOW);
+  #endif
 }
 
-void GameConsoleController::preSubmit()
+template <class Features>
+bool GameConsoleController<Features>::detectPad(bool present)
 {
+  padAnswered = present;
+  if (present == padPresent)
+  {
+    padDebounce = 0;
+  }
+  else if (++padDebounce >= HOTPLUG_DEBOUNCE)
+  {
+    padPresent = present;
+    padDebounce = 0;
+    if (padPresent) DEBUG_INFO("Controller: Connected");
+    else
+    {
+      /** Nothing may keep pressing buttons for a pad that is gone **/
+      if (Features::macro) macro.stop();
+      if (Features::recorder) recorder.stopPlayback();
+      DEBUG_WARNING("Controller: Disconnected");
+    }
+  }
+  return padPresent;
 }
 
-void GameConsoleController::submit()
+template <class Features>
+void GameConsoleController<Features>::postFetch()
 {
+  if ((Features::logoEmulation && emulateLogoButton()) || deactivated || !modifications) return;
+
+  /** Releases caused by a missing pad must not start playback or toggle anything **/
+  if (!padAnswered) return;
+
+  if (!handleDeactivation())
+    if (!(Features::autofire && handleAutoFire()))
+      if (!(Features::macro && handleMacro()))
+        if (!(Features::recorder && handleRecording()))
+          return;
+}
+
+template <class Features>
+bool GameConsoleController<Features>::emulateLogoButton() {
+  if (button[EMU_LOGO_BUTTON1].held && button[EMU_LOGO_BUTTON2].held)
+  {
+    button[SNES_EMU_LOGO].updateInput(true);
+    return false;
+  }
+  button[SNES_EMU_LOGO].updateInput(false);
+  return false;
+}
+
+template <class Features>
+bool GameConsoleController<Features>::handleDeactivation() {
+  int duration = DEACTIVATION_BUTTON_TIME * 1000;
+  if (button[DEACTIVATION_BUTTON].duration > duration && button[DEACTIVATION_BUTTON].held)
+  {
+    int time_window_after_boot = DEACTIVATION_TIME_WINDOW * 1000;
+    if (millis() < time_window_after_boot)
+    {
+      button[DEACTIVATION_BUTTON].reset();
+      deactivated = true;
+      if (Features::macro) macro.stop();
+
+      DEBUG_WARNING("Modifications disabled until power reset");
+      if (Debug.getDebugLevel() > -1) Debug.setDebugLevel(DBG_ERROR);
+      return true;
+    }
+    else DEBUG_WARNING("Disabling of modifications only possible within the first %i seconds", time_window_after_boot);
+  }
+  return false;
+}
+
+template <class Features>
+bool GameConsoleController<Features>::handleAutoFire() {
+  int autoFireButtons[] = { SNES_A, SNES_B, SNES_X, SNES_Y, SNES_L, SNES_R };
+  for (int id = 0; id < 6; ++id)
+  {
+    int autoFire = autoFireButtons[id];
+    if (button[AUTOFIRE_BUTTON].held && button[autoFire].released)
+    {
+      button[autoFire].toggleMode();
+      switch (button[autoFire].mode)
+      {
+      case MODE_NORMAL:
+        DEBUG_INFO("%s Auto-Fire: Disabled", regularButtonIdentifier[autoFire]);
+        break;
+      case MODE_AUTOFIRE:
+        DEBUG_INFO("%s Auto-Fire: Enabled", regularButtonIdentifier[autoFire]);
+        break;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class Features>
+bool GameConsoleController<Features>::handleMacro() {
+  if (button[MACRO_MODIFIER_BUTTON].held && button[MACRO_BUTTON].released && recorder.isIdle())
+  {
+    if (macro.isRunning())
+    {
+      macro.stop();
+      DEBUG_DEBUG("Macro: Stopped");
+    }
+    else
+    {
+      macro.start();
+      DEBUG_DEBUG("Macro: Started");
+    }
+    return true;
+  }
+  return false;
+}
+
+template <class Features>
+bool GameConsoleController<Features>::handleRecording() {
+  int duration = CONTINUOUS_BUTTON_TIME * 1000;
+  bool startRecording = button[PROGRAM_BUTTON].released && button[PROGRAM_BUTTON].clicks == PROGRAM_BUTTON_REC_CLICKS;
+  if (recorder.isIdle())
+  {
+    if (startRecording)
+    {
+      recorder.startRecording();
+      DEBUG_DEBUG("Recording: Started");
+      return true;
+    }
+    else if (button[PROGRAM_BUTTON].released && button[PROGRAM_BUTTON].clicks == PROGRAM_BUTTON_PLAY_CLICKS && recorder.hasRecord() && button[PROGRAM_BUTTON].duration < MULTICLICK_TIMEOUT)
+    {
+      recorder.startPlayback();
+      DEBUG_DEBUG("Playback: Started");
+      return true;
+    }
+    else if (recorder.continuousPlayback && button[PROGRAM_BUTTON].held) 
+    {
+      recorder.startPlayback();
+      DEBUG_DEBUG("Continuous Playback: Looped");
+      return true;
+    }
+  }
+  else if (recorder.isRecording())
+  {
+    if (button[PROGRAM_BUTTON].released && button[PROGRAM_BUTTON].clicks == PROGRAM_BUTTON_SAVE_CLICKS)
+    {
+      recorder.endRecording();
+      recorder.continuousPlayback = false;
+
+      int recordedButtons = recorder.countRecords();
+      if (recordedButtons > 0) DEBUG_INFO("Recording: Finished (%i Buttonpresses saved)", recordedButtons);
+      else DEBUG_DEBUG("Recording: Aborted");
+
+      return true;
+    }
+    else if (button[PROGRAM_BUTTON].held && button[PROGRAM_BUTTON].duration > duration) 
+    {
+      recorder.endRecording();
+      recorder.continuousPlayback = true;
+
+      int recordedButtons = recorder.countRecords();
+      if (recordedButtons > 0) DEBUG_INFO("Recording: Finished (%i Buttonpresses saved), Continuous Playback", recordedButtons);
+      else DEBUG_DEBUG("Recording: Aborted");
+
+      return true;
+    }
+  }
+  else if (recorder.continuousPlayback && recorder.hasRecord() && startRecording)
+  {
+      recorder.startRecording();
+      DEBUG_DEBUG("Recording: Started");
+  }
+  return false;
 }
+
+template <class Features>
+ControllerButton GameConsoleController<Features>::get(int id)
+{
+  return button[id];
+}
+
+template <class Features>
+void GameConsoleController<Features>::set(int id, ControllerButton buttonUpdate)
+{
+  button[id] = buttonUpdate;
+}
+
+template <class Features>
+void GameConsoleController<Features>::preSubmit()
+{
+  if (!buttonTracking) return;
+
+  int forcePlaybackButton = Features::recorder ? recorder.playback() : -1;
+  uint16_t macroButtons = Features::macro ? macro.step() : 0;
+  for (int id = 0; id < SNES_BTN_NUM + 1; ++id)
+  {
+    bool emulatingLogoButton = Features::logoEmulation && button[SNES_EMU_LOGO].held && (id == EMU_LOGO_BUTTON1 || id == EMU_LOGO_BUTTON2);
+    bool skipProgramButton = Features::recorder && recorder.countRecords() > 0 && button[PROGRAM_BUTTON].held && id == PROGRAM_BUTTON;
+    if (emulatingLogoButton || skipProgramButton)
+    {
+        button[id].ignore();
+    }
+    else 
+    {
+      button[id].process();
+      if (Features::recorder && recorder.isRecording())
+      {
+        if (button[id].pressed && id != PROGRAM_BUTTON) 
+        {
+          if (recorder.record(id)) DEBUG_DEBUG("%s Recording", regularButtonIdentifier[id]);
+          else DEBUG_ERROR("%s Recording: FAILED", regularButtonIdentifier[id]);
+        }
+        button[id].ignore();
+      }
+      else if (forcePlaybackButton > -1)
+      {
+        if (id == forcePlaybackButton)
+        {
+          DEBUG_DEBUG("%s Playback", regularButtonIdentifier[id]);
+          button[id].fire();
+        }
+        else button[id].ignore();
+      }
+      else if (Features::macro && macro.isRunning())
+      {
+        if (macroButtons & (1 << id)) button[id].fire();
+        else button[id].ignore();
+      }
+    }
+  }
+}
+
+template <class Features>
+bool GameConsoleController<Features>::isActive()
+{
+  return inputChanged || sentPad || stick.x || stick.y || (Features::macro && macro.isRunning()) || (Features::recorder && !recorder.isIdle());
+}
+
+template <class Features>
+uint16_t GameConsoleController<Features>::packOutputs()
+{
+  if (!buttonTracking) return inputPad;
+
+  uint16_t pad = 0;
+  for (int id = 0; id < SNES_BTN_NUM + 1; ++id)
+  {
+    if (button[id].output) pad |= (1 << id);
+  }
+  return pad;
+}
+
+template <class Features>
+void GameConsoleController<Features>::submit()
+{
+  uint16_t pad = padPresent ? packOutputs() : 0;  // neutral while no pad is plugged in
+
+  /** Resolve the d-pad in place (bits SNES_UP..SNES_RIGHT) **/
+  uint8_t dpad = socd.resolve((pad >> SNES_UP) & 0x0F);
+  if (STICK_EMULATION == STICK_LEFT)
+  {
+    stick.update(dpad);
+    dpad = 0;
+  }
+  pad = (pad & ~(0x0F << SNES_UP)) | (dpad << SNES_UP);
+
+  if (switchAB)
+  {
+    uint16_t a = (pad >> SNES_A) & 1;
+    uint16_t b = (pad >> SNES_B) & 1;
+    pad = (pad & ~(bit(SNES_A) | bit(SNES_B))) | (a << SNES_B) | (b << SNES_A);
+  }
+
+  output.send(pad, stick.x, stick.y);
+  sentPad = pad;
+
+  #if OUTPUT_BACKEND == OUTPUT_XINPUT && !defined(USB_XINPUT)
+    for (int id = 0; id < SNES_BTN_NUM + 1; ++id)
+    {
+      if (Features::debug && button[id].held && recorder.isIdle() && !recorder.isRecording())
+      {
+          DEBUG_INFO("%s (%s)", switchAB ? switchedButtonIdentifier[id] : regularButtonIdentifier[id], button[id].output ? "*" : " ");      
+      }
+    }
+  #endif
+}
+
+template <class Features>
+void GameConsoleController<Features>::reportMemory()
+{
+  int labels = 0;
+  for (int id = 0; id < SNES_BTN_NUM + 1; ++id)
+  {
+    labels += strlen(regularButtonIdentifier[id]) + strlen(switchedButtonIdentifier[id]) + 2;
+  }
+  labels += sizeof(regularButtonIdentifier) + sizeof(switchedButtonIdentifier);
+
+  DEBUG_INFO("RAM: %u bytes controller", sizeof(GameConsoleController));
+  DEBUG_INFO("RAM:   %u bytes buttons (%i x %u)", sizeof(button), SNES_BTN_NUM + 1, sizeof(ControllerButton));
+  DEBUG_INFO("RAM:   %u bytes recorder", sizeof(recorder));
+  DEBUG_INFO("RAM:   %u bytes socd", sizeof(socd));
+  DEBUG_INFO("RAM:   %u bytes stick", sizeof(stick));
+  DEBUG_INFO("RAM:   %u bytes output", sizeof(output));
+  DEBUG_INFO("RAM:   %u bytes macro (%u bytes script in flash)", sizeof(macro), sizeof(macroScript));
+  DEBUG_INFO("RAM: %i bytes button labels", labels);
+}
+
+template class GameConsoleController<FullFeatures>;
+template class GameConsoleController<PassthroughFeatures>;
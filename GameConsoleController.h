@@ -29,9 +29,77 @@
 
 #include "Arduino.h"
 #include "ControllerButton.h"
+#include "ButtonPressRecorder.h"
+#include "SOCDResolver.h"
+#include "StickEmulator.h"
+#include "MacroInterpreter.h"
+#include "OutputBackend.h"
+#include "FeaturePolicy.h"
 
+/** BUTTONS **/
+#define SNES_BTN_NUM  12
+#define SNES_B        0
+#define SNES_Y        1
+#define SNES_SELECT   2
+#define SNES_START    3
+#define SNES_UP       4
+#define SNES_DOWN     5
+#define SNES_LEFT     6
+#define SNES_RIGHT    7
+#define SNES_A        8
+#define SNES_X        9
+#define SNES_L        10
+#define SNES_R        11
+#define SNES_EMU_LOGO SNES_BTN_NUM
+
+#define EMU_LOGO_BUTTON1            SNES_SELECT   // id of auto fire mode button
+#define EMU_LOGO_BUTTON2            SNES_START    // id of auto fire mode button
+
+#define AUTOFIRE_BUTTON             SNES_SELECT   // id of auto fire mode button
+
+#define PROGRAM_BUTTON              SNES_SELECT   // id of record program mode button
+#define PROGRAM_BUTTON_REC_CLICKS   2             // how many clicks to start recording
+#define PROGRAM_BUTTON_SAVE_CLICKS  2             // how many clicks to save program mode
+#define PROGRAM_BUTTON_PLAY_CLICKS  1             // how many clicks to playback program
+#define CONTINUOUS_BUTTON_TIME      3             // seconds: minimum time to 
+
+/** MACRO **/
+#define MACRO_MODIFIER_BUTTON       SNES_SELECT   // hold this button ...
+#define MACRO_BUTTON                SNES_UP       // ... and press this one to start / stop the macro
+#define MACRO_SCRIPT                              /* rapid B, ten times */ \
+  MACRO_LOOP(10),                                                           \
+    MACRO_PRESS(bit(SNES_B)),   MACRO_WAIT(16),                             \
+    MACRO_RELEASE(bit(SNES_B)), MACRO_WAIT(16),                             \
+  MACRO_NEXT,                                                               \
+  MACRO_END
+
+/** SOCD **/
+#define SOCD_MODE                   SOCD_UP_PRIORITY  // how opposing d-pad directions are resolved
+
+/** STICK EMULATION **/
+#define STICK_EMULATION             STICK_OFF           // STICK_LEFT: d-pad drives the left analog stick
+#define STICK_CURVE                 STICK_CURVE_LINEAR  // ramp-up curve of the emulated stick
+#define STICK_RAMP_TIME             8                   // milliseconds per ramp step (15 steps to full deflection)
+
+/** STARTUP **/
+#define STARTUP_WAITING             0             // waiting for the host, pad is already polled
+#define STARTUP_GREETING            1             // host connected, blinking the LED
+#define STARTUP_READY               2
+#define STARTUP_BLINKS              4             // LED toggles after the host connected
+#define STARTUP_BLINK_TIME          350           // milliseconds per LED toggle
+
+/** HOT-PLUG **/
+#define HOTPLUG_DEBOUNCE            4             // polls with a consistent pad state before (dis)connecting
+
+/** DEACTIVATION **/
+#define DEACTIVATION_BUTTON         SNES_SELECT   // id of deactivation button
+#define DEACTIVATION_BUTTON_TIME    5             // seconds: minimum time to press 
+#define DEACTIVATION_TIME_WINDOW    30            // seconds: time window after power on to deactivate mods
+
+template <class Features = FullFeatures>
 class GameConsoleController {
 public:
+  GameConsoleController(int switchedAB = 1);
   void setup();
   void preFetch();
   void fetch();
@@ -40,8 +108,44 @@ public:
   void set(int id, ControllerButton buttonUpdate);
   void preSubmit();
   void submit();
+  bool isActive();
+  bool isHostConnected();
+  void reportMemory();
 
 protected:
+  void updateButtons(uint16_t pressed);
+  bool detectPad(bool present);
+
+private:
+  /** Modes, clicks and hold times are only needed by these features **/
+  static const bool modifications = Features::autofire || Features::recorder || Features::macro;
+  static const bool buttonTracking = modifications || Features::logoEmulation || Features::debug;
+
+  ControllerButton button[SNES_BTN_NUM + 1];
+  typename FeatureType<Features::recorder, ButtonPressRecorder, NoRecorder>::Type recorder;
+  SOCDResolver socd;
+  StickEmulator stick;
+  typename FeatureType<Features::macro, MacroInterpreter, NoMacro>::Type macro;
+  OutputBackend output;
+  bool deactivated;
+  bool switchAB;
+  bool inputChanged;
+  uint16_t inputPad;
+  uint16_t sentPad;
+  uint8_t startupState;
+  uint32_t startupTime;
+  bool padPresent;
+  bool padAnswered;
+  uint8_t padDebounce;
+
+  bool emulateLogoButton();
+  void handleStartup();
+  uint16_t packOutputs();
+
+  bool handleDeactivation();
+  bool handleAutoFire();
+  bool handleRecording();
+  bool handleMacro();
 };
 
 #endif // GAMECONSOLECONTROLLER_H
\ No newline at end of file
@@ -0,0 +1,142 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "GameConsoleController.h"
+
+#if OUTPUT_BACKEND == OUTPUT_GAMEPAD
+
+static const uint8_t gamepadReportDescriptor[] PROGMEM = {
+  0x05, 0x01,         // USAGE_PAGE (Generic Desktop)
+  0x09, 0x05,         // USAGE (Game Pad)
+  0xa1, 0x01,         // COLLECTION (Application)
+  0x05, 0x09,         //   USAGE_PAGE (Button)
+  0x19, 0x01,         //   USAGE_MINIMUM (Button 1)
+  0x29, 0x09,         //   USAGE_MAXIMUM (Button 9)
+  0x15, 0x00,         //   LOGICAL_MINIMUM (0)
+  0x25, 0x01,         //   LOGICAL_MAXIMUM (1)
+  0x75, 0x01,         //   REPORT_SIZE (1)
+  0x95, 0x09,         //   REPORT_COUNT (9)
+  0x81, 0x02,         //   INPUT (Data,Var,Abs)
+  0x95, 0x03,         //   REPORT_COUNT (3)
+  0x81, 0x03,         //   INPUT (Cnst,Var,Abs)
+  0x05, 0x01,         //   USAGE_PAGE (Generic Desktop)
+  0x09, 0x39,         //   USAGE (Hat switch)
+  0x15, 0x00,         //   LOGICAL_MINIMUM (0)
+  0x25, 0x07,         //   LOGICAL_MAXIMUM (7)
+  0x35, 0x00,         //   PHYSICAL_MINIMUM (0)
+  0x46, 0x3b, 0x01,   //   PHYSICAL_MAXIMUM (315)
+  0x65, 0x14,         //   UNIT (Eng Rot:Angular Pos)
+  0x75, 0x04,         //   REPORT_SIZE (4)
+  0x95, 0x01,         //   REPORT_COUNT (1)
+  0x81, 0x42,         //   INPUT (Data,Var,Abs,Null)
+  0xc0                // END_COLLECTION
+};
+
+/** Hat switch value per d-pad mask (up, down, left, right), 0x0F = centered **/
+static const uint8_t hatSwitch[16] PROGMEM = {
+  0x0F, 0, 4, 0x0F, 6, 7, 5, 6, 2, 1, 3, 2, 0x0F, 0, 4, 0x0F
+};
+
+GamepadOutput::GamepadOutput() : PluggableUSBModule(1, 1, epType), protocol(HID_REPORT_PROTOCOL), idle(1)
+{
+  epType[0] = EP_TYPE_INTERRUPT_IN;
+  memset(report, 0, sizeof(report));
+  report[1] = 0x0E;  // padding bits are never sent set, so the first report always goes out
+  PluggableUSB().plug(this);
+}
+
+int GamepadOutput::getInterface(uint8_t* interfaceCount)
+{
+  *interfaceCount += 1;
+  HIDDescriptor hidInterface = {
+    D_INTERFACE(pluggedInterface, 1, USB_DEVICE_CLASS_HUMAN_INTERFACE, HID_SUBCLASS_NONE, HID_PROTOCOL_NONE),
+    D_HIDREPORT(sizeof(gamepadReportDescriptor)),
+    D_ENDPOINT(USB_ENDPOINT_IN(pluggedEndpoint), USB_ENDPOINT_TYPE_INTERRUPT, USB_EP_SIZE, GAMEPAD_POLL_INTERVAL)
+  };
+  return USB_SendControl(0, &hidInterface, sizeof(hidInterface));
+}
+
+int GamepadOutput::getDescriptor(USBSetup& setup)
+{
+  if (setup.bmRequestType != REQUEST_DEVICETOHOST_STANDARD_INTERFACE) return 0;
+  if (setup.wValueH != HID_REPORT_DESCRIPTOR_TYPE) return 0;
+  if (setup.wIndex != pluggedInterface) return 0;
+
+  protocol = HID_REPORT_PROTOCOL;
+  return USB_SendControl(TRANSFER_PGM, gamepadReportDescriptor, sizeof(gamepadReportDescriptor));
+}
+
+bool GamepadOutput::setup(USBSetup& setup)
+{
+  if (pluggedInterface != setup.wIndex) return false;
+
+  if (setup.bmRequestType == REQUEST_DEVICETOHOST_CLASS_INTERFACE)
+  {
+    if (setup.bRequest == HID_GET_REPORT) return true;
+    if (setup.bRequest == HID_GET_PROTOCOL) return true;
+  }
+  if (setup.bmRequestType == REQUEST_HOSTTODEVICE_CLASS_INTERFACE)
+  {
+    if (setup.bRequest == HID_SET_PROTOCOL)
+    {
+      protocol = setup.wValueL;
+      return true;
+    }
+    if (setup.bRequest == HID_SET_IDLE)
+    {
+      idle = setup.wValueL;
+      return true;
+    }
+  }
+  return false;
+}
+
+void GamepadOutput::begin()
+{
+}
+
+bool GamepadOutput::connected()
+{
+  return USBDevice.configured();
+}
+
+void GamepadOutput::send(uint16_t pad, int16_t stickX, int16_t stickY)
+{
+  /** B, Y, Select, Start, A, X, L, R, Logo, padding, hat switch **/
+  uint8_t buttons = (pad & 0x0F) | ((pad >> 4) & 0xF0);
+  uint8_t extra = ((pad >> SNES_EMU_LOGO) & 0x01) | (pgm_read_byte(&hatSwitch[(pad >> SNES_UP) & 0x0F]) << 4);
+
+  /** Only report changes, the host keeps the last state **/
+  if (buttons == report[0] && extra == report[1]) return;
+  uint8_t next[sizeof(report)] = { buttons, extra };
+
+  /** Keep the old state if the report did not go out (not enumerated yet, timeout) **/
+  if (USB_Send(pluggedEndpoint | TRANSFER_RELEASE, next, sizeof(next)) < 0) return;
+  report[0] = buttons;
+  report[1] = extra;
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef GAMEPADOUTPUT_H
+#define GAMEPADOUTPUT_H
+
+#include "Arduino.h"
+#include "PluggableUSB.h"
+#include "HID.h"
+
+#define GAMEPAD_REPORT_SIZE     2  // 9 buttons, 3 bits padding, 4 bit hat switch
+
+class GamepadOutput : public PluggableUSBModule {
+public:
+  GamepadOutput();
+  void begin();
+  bool connected();
+  void send(uint16_t pad, int16_t stickX, int16_t stickY);
+
+protected:
+  int getInterface(uint8_t* interfaceCount);
+  int getDescriptor(USBSetup& setup);
+  bool setup(USBSetup& setup);
+
+private:
+  uint8_t epType[1];
+  uint8_t protocol;
+  uint8_t idle;
+  uint8_t report[GAMEPAD_REPORT_SIZE];
+};
+
+#endif // GAMEPADOUTPUT_H
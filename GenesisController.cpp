@@ -0,0 +1,144 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "GenesisController.h"
+
+/** Lines as returned by select(): set bit = line low **/
+#define LINE_UP       0x01
+#define LINE_DOWN     0x02
+#define LINE_LEFT     0x04
+#define LINE_RIGHT    0x08
+#define LINE_TL       0x10
+#define LINE_TR       0x20
+#define LINE_DPAD     (LINE_UP | LINE_DOWN | LINE_LEFT | LINE_RIGHT)
+
+template <class Features>
+GenesisController<Features>::GenesisController(int switchedAB) : GameConsoleController<Features>(switchedAB)
+{
+  state = 0;
+  present = false;
+  lastCycle = 0;
+}
+
+template <class Features>
+void GenesisController<Features>::setup()
+{
+  GameConsoleController<Features>::setup();
+
+  // Setup direction pins (A3..A0 or PF4..PF7)
+  DDRF  &= ~B11110000; // inputs
+  PORTF |=  B11110000; // enable internal pull-ups
+
+  // Setup TL / TR pins (15/14 or PB1/PB3)
+  DDRB  &= ~B00001010; // inputs
+  PORTB |=  B00001010; // enable internal pull-ups
+
+  // Setup select pin (16 or PB2), normally HIGH
+  DDRB  |=  B00000100; // output
+  PORTB |=  B00000100; // high
+}
+
+template <class Features>
+uint8_t GenesisController<Features>::select(bool high)
+{
+  if (high) PORTB |= B00000100;
+  else PORTB &= ~B00000100;
+  __builtin_avr_delay_cycles(GENESIS_SELECT_DELAY);
+
+  uint8_t f = PINF;
+  uint8_t b = PINB;
+  uint8_t lines = ((f >> 4) & 0x0F) | ((b & B00000010) << 3) | ((b & B00001000) << 2);
+  return ~lines & 0x3F;
+}
+
+template <class Features>
+void GenesisController<Features>::readPad()
+{
+  /**
+   * Select cycle, starting with select HIGH:
+   *   LOW  1: up, down, 0, 0, A, Start (left and right low = pad present)
+   *   HIGH 1: up, down, left, right, B, C
+   *   LOW  2, HIGH 2
+   *   LOW  3: up, down, left and right all low on a 6 button pad
+   *   HIGH 3: Z, Y, X, Mode on the direction lines
+   *   LOW  4, HIGH 4: back to the start of the cycle
+   **/
+  uint8_t low1 = select(LOW);
+  uint8_t high1 = select(HIGH);
+  select(LOW);
+  select(HIGH);
+  uint8_t low3 = select(LOW);
+  uint8_t high3 = select(HIGH);
+  select(LOW);
+  select(HIGH);
+
+  /** An open port reads as all released, like the SNES data line **/
+  present = (low1 & (LINE_LEFT | LINE_RIGHT)) == (LINE_LEFT | LINE_RIGHT);
+  if (!present)
+  {
+    state = 0;
+    return;
+  }
+
+  uint16_t pressed = 0;
+  if (high1 & LINE_UP)    pressed |= bit(SNES_UP);
+  if (high1 & LINE_DOWN)  pressed |= bit(SNES_DOWN);
+  if (high1 & LINE_LEFT)  pressed |= bit(SNES_LEFT);
+  if (high1 & LINE_RIGHT) pressed |= bit(SNES_RIGHT);
+  if (high1 & LINE_TL)    pressed |= bit(SNES_B);       // B
+  if (high1 & LINE_TR)    pressed |= bit(SNES_A);       // C
+  if (low1 & LINE_TL)     pressed |= bit(SNES_X);       // A
+  if (low1 & LINE_TR)     pressed |= bit(SNES_START);   // Start
+
+  if ((low3 & LINE_DPAD) == LINE_DPAD)
+  {
+    if (high3 & LINE_UP)    pressed |= bit(SNES_R);       // Z
+    if (high3 & LINE_DOWN)  pressed |= bit(SNES_Y);       // Y
+    if (high3 & LINE_LEFT)  pressed |= bit(SNES_L);       // X
+    if (high3 & LINE_RIGHT) pressed |= bit(SNES_SELECT);  // Mode
+  }
+  state = pressed;
+}
+
+template <class Features>
+void GenesisController<Features>::fetch()
+{
+  /** Keep the last state until the pad has reset its select counter **/
+  uint32_t now = micros();
+  if (now - lastCycle >= GENESIS_CYCLE_PAUSE)
+  {
+    readPad();
+    lastCycle = micros();
+
+    /** Release everything while no pad is plugged in **/
+    if (!this->detectPad(present)) state = 0;
+  }
+
+  this->updateButtons(state);
+}
+
+template class GenesisController<FullFeatures>;
+template class GenesisController<PassthroughFeatures>;
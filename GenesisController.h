@@ -0,0 +1,63 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef GENESISCONTROLLER_H
+#define GENESISCONTROLLER_H
+
+#include "GameConsoleController.h"
+
+/** TIMING **/
+#define GENESIS_SELECT_DELAY    160   // cycles: settle time after toggling select (10us)
+#define GENESIS_CYCLE_PAUSE     1800  // microseconds: pause before the next read, lets the 6 button pad reset
+
+/** PINS (DB9 pin: function) **/
+#define GENESIS_POW_5V          -1    // 5: +5V
+#define GENESIS_POW_GND         -1    // 8: GND
+#define GENESIS_UP              21    // 1: up           (A3 / PF4)
+#define GENESIS_DOWN            20    // 2: down         (A2 / PF5)
+#define GENESIS_LEFT            19    // 3: left         (A1 / PF6)
+#define GENESIS_RIGHT           18    // 4: right        (A0 / PF7)
+#define GENESIS_TL              15    // 6: B / A        (PB1)
+#define GENESIS_TR              14    // 9: C / Start    (PB3)
+#define GENESIS_TH              16    // 7: select       (PB2)
+
+template <class Features = FullFeatures>
+class GenesisController : public GameConsoleController<Features> {
+public:
+  GenesisController(int switchedAB = 1);
+  void setup();
+  void fetch();
+
+private:
+  uint16_t state;
+  bool present;
+  uint32_t lastCycle;
+
+  uint8_t select(bool high);
+  void readPad();
+};
+
+#endif // GENESISCONTROLLER_H
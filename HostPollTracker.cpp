@@ -0,0 +1,224 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "HostPollTracker.h"
+
+static uint8_t commonPeriod(uint8_t period, uint32_t frames)
+{
+  /** Greatest common divisor, never larger than the current period **/
+  uint32_t divisor = period;
+  while (frames > 0)
+  {
+    uint32_t rest = divisor % frames;
+    divisor = frames;
+    frames = rest;
+  }
+  return divisor;
+}
+
+HostPollTracker::HostPollTracker()
+{
+  pending = false;
+  sofTracked = false;
+  lastFrame = 0;
+  frames = 0;
+  drainFrame = 0;
+  sofAt = 0;
+  readAt = 0;
+  sentAt = 0;
+  wokeAt = 0;
+  lead = POLL_SYNC_GUARD_US;
+  unlock();
+}
+
+void HostPollTracker::unlock()
+{
+  samples = 0;
+  period = XINPUT_TX_INTERVAL;
+  offset = 0;
+}
+
+bool HostPollTracker::isLocked()
+{
+  return samples >= POLL_SYNC_SAMPLES;
+}
+
+uint32_t HostPollTracker::interval()
+{
+  return period * 1000UL;
+}
+
+uint16_t HostPollTracker::leadTime()
+{
+  return lead;
+}
+
+bool HostPollTracker::bankFree()
+{
+  #ifdef USB_XINPUT
+    /** TXINI is set by hardware once the host has collected the IN bank **/
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t endpoint = UENUM;
+    UENUM = XINPUT_TX_ENDPOINT;
+    bool free = UEINTX & (1 << TXINI);
+    UENUM = endpoint;
+    SREG = sreg;
+    return free;
+  #else
+    return true;
+  #endif
+}
+
+uint16_t HostPollTracker::frameNumber()
+{
+  #ifdef USB_XINPUT
+    /** 11 bit number of the last start of frame, sent by the host every millisecond **/
+    uint8_t high;
+    uint8_t low;
+    do {
+      high = UDFNUMH;
+      low = UDFNUML;
+    } while (high != UDFNUMH);
+    return ((high << 8) | low) & 0x7FF;
+  #else
+    return 0;
+  #endif
+}
+
+void HostPollTracker::updateFrame()
+{
+  uint32_t now = micros();
+  uint16_t frame = frameNumber();
+  if (frame != lastFrame)
+  {
+    uint16_t elapsed = (frame - lastFrame) & 0x7FF;
+    frames += elapsed;
+    lastFrame = frame;
+
+    /** Frames start exactly one millisecond apart, so a start seen while spinning anchors the later ones **/
+    if (now - readAt < POLL_SYNC_GUARD_US)
+    {
+      sofAt = now;
+      sofTracked = true;
+    }
+    else if (sofTracked && elapsed <= POLL_SYNC_EXTRAPOLATE)
+    {
+      sofAt += elapsed * 1000UL;
+    }
+    else sofTracked = false;
+  }
+  readAt = now;
+}
+
+void HostPollTracker::observeDrain()
+{
+  uint32_t drainInterval = frames - drainFrame;
+  drainFrame = frames;
+
+  if (samples == 0)
+  {
+    samples = 1;
+    return;
+  }
+
+  /** The host only transfers on its schedule, so every interval is a multiple of its period **/
+  uint8_t common = commonPeriod(period, drainInterval);
+  if (common != period)
+  {
+    period = common;
+    samples = 1;
+  }
+  else if (samples < POLL_SYNC_SAMPLES) samples += 1;
+
+  /** Track the earliest transfer time within the frame **/
+  if (sofTracked)
+  {
+    uint16_t transferAt = min(micros() - sofAt, 999UL);
+    if (transferAt < offset || samples == 1) offset = transferAt;
+    else offset += (transferAt - offset) >> 4;
+  }
+}
+
+void HostPollTracker::waitForSlot()
+{
+  /** Wait until the host has collected the previous report **/
+  bool waited = false;
+  while (pending)
+  {
+    updateFrame();
+    if (bankFree())
+    {
+      /** A drain that happened before we started watching has an unknown frame **/
+      if (waited) observeDrain();
+      pending = false;
+    }
+    else if (micros() - sentAt > POLL_SYNC_TIMEOUT_US)
+    {
+      pending = false;
+      unlock();
+    }
+    else waited = true;
+  }
+  updateFrame();
+
+  /** Sleep until the sample can just be taken before the next transfer **/
+  if (isLocked())
+  {
+    int32_t ahead = (int32_t)lead - offset;             // microseconds before the transfer frame starts
+    uint8_t early = ahead > 0 ? (ahead + 999) / 1000 : 0;
+    uint16_t wakeDelay = early * 1000 - ahead;          // microseconds after the start of the wake frame
+    uint8_t remaining = (frames + early - drainFrame) % period;
+    uint32_t wakeFrame = frames + (remaining ? period - remaining : 0);
+    if (wakeFrame == frames && !(sofTracked && micros() - sofAt < wakeDelay)) wakeFrame += period;
+
+    uint32_t start = micros();
+    while (true)
+    {
+      updateFrame();
+      int32_t framesLeft = wakeFrame - frames;
+      if (framesLeft < 0 || (framesLeft == 0 && micros() - sofAt >= wakeDelay)) break;
+      if (micros() - start > POLL_SYNC_TIMEOUT_US)
+      {
+        unlock();
+        break;
+      }
+    }
+  }
+  wokeAt = micros();
+}
+
+void HostPollTracker::sent()
+{
+  sentAt = micros();
+  if (bankFree()) return;  // nothing queued (report unchanged)
+  pending = true;
+
+  /** Track the time needed from wake-up to a queued report **/
+  uint16_t needed = (sentAt - wokeAt) + POLL_SYNC_GUARD_US;
+  if (needed > lead) lead = needed;
+  else lead -= (lead - needed) >> 4;
+}
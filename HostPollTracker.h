@@ -0,0 +1,77 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef HOSTPOLLTRACKER_H
+#define HOSTPOLLTRACKER_H
+
+#include "Arduino.h"
+
+#ifndef XINPUT_TX_ENDPOINT
+  #define XINPUT_TX_ENDPOINT  1
+#endif
+
+#ifndef XINPUT_TX_INTERVAL
+  #define XINPUT_TX_INTERVAL  4      // frames: bInterval of the XInput IN endpoint, the longest possible host period
+#endif
+
+#define POLL_SYNC_SAMPLES     8      // drains on the learned schedule before the host phase is trusted
+#define POLL_SYNC_GUARD_US    64     // microseconds: safety margin before the predicted transfer
+#define POLL_SYNC_TIMEOUT_US  20000  // microseconds: give up waiting for a host that stopped polling
+#define POLL_SYNC_EXTRAPOLATE 16     // frames: longest gap over which frame start times are extrapolated
+
+class HostPollTracker {
+public:
+  HostPollTracker();
+
+  void waitForSlot();
+  void sent();
+  bool isLocked();
+  uint32_t interval();
+  uint16_t leadTime();
+
+private:
+  bool pending;
+  bool sofTracked;
+  uint8_t samples;
+  uint8_t period;
+  uint16_t offset;
+  uint16_t lead;
+  uint16_t lastFrame;
+  uint32_t frames;
+  uint32_t drainFrame;
+  uint32_t sofAt;
+  uint32_t readAt;
+  uint32_t sentAt;
+  uint32_t wokeAt;
+
+  bool bankFree();
+  uint16_t frameNumber();
+  void updateFrame();
+  void observeDrain();
+  void unlock();
+};
+
+#endif // HOSTPOLLTRACKER_H
@@ -0,0 +1,82 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "GameConsoleController.h"
+
+#if OUTPUT_BACKEND == OUTPUT_KEYBOARD
+
+#include <Keyboard.h>
+
+/** Key per button id, 0 = unmapped **/
+const uint8_t keyMap[SNES_BTN_NUM + 1] PROGMEM = {
+  'z',                // SNES_B
+  'a',                // SNES_Y
+  KEY_RIGHT_SHIFT,    // SNES_SELECT
+  KEY_RETURN,         // SNES_START
+  KEY_UP_ARROW,       // SNES_UP
+  KEY_DOWN_ARROW,     // SNES_DOWN
+  KEY_LEFT_ARROW,     // SNES_LEFT
+  KEY_RIGHT_ARROW,    // SNES_RIGHT
+  'x',                // SNES_A
+  's',                // SNES_X
+  'q',                // SNES_L
+  'w',                // SNES_R
+  KEY_F1              // SNES_EMU_LOGO
+};
+
+void KeyboardOutput::begin()
+{
+  last = 0;
+  Keyboard.begin();
+}
+
+bool KeyboardOutput::connected()
+{
+  return USBDevice.configured();
+}
+
+void KeyboardOutput::send(uint16_t pad, int16_t stickX, int16_t stickY)
+{
+  /** Keys pressed before enumeration are sent once the host is there **/
+  if (!USBDevice.configured()) return;
+
+  /** Only touch keys whose button changed since the last report **/
+  uint16_t changed = pad ^ last;
+  last = pad;
+
+  for (int id = 0; changed; ++id, changed >>= 1)
+  {
+    if (!(changed & 1)) continue;
+
+    uint8_t key = pgm_read_byte(&keyMap[id]);
+    if (!key) continue;
+
+    if (pad & bit(id)) Keyboard.press(key);
+    else Keyboard.release(key);
+  }
+}
+
+#endif
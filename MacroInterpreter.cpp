@@ -0,0 +1,134 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "MacroInterpreter.h"
+
+MacroInterpreter::MacroInterpreter(const uint8_t* program, uint8_t length)
+{
+  this->program = program;
+  this->length = length;
+  running = false;
+  pc = 0;
+  wait = 0;
+  waitStart = 0;
+  speed = MACRO_SPEED_NORMAL;
+  held = 0;
+  depth = 0;
+}
+
+void MacroInterpreter::start()
+{
+  running = length > 0;
+  pc = 0;
+  wait = 0;
+  speed = MACRO_SPEED_NORMAL;
+  held = 0;
+  depth = 0;
+}
+
+void MacroInterpreter::stop()
+{
+  running = false;
+  held = 0;
+}
+
+bool MacroInterpreter::isRunning()
+{
+  return running;
+}
+
+uint8_t MacroInterpreter::fetch()
+{
+  if (pc >= length)
+  {
+    stop();
+    return OP_END;
+  }
+  return pgm_read_byte(program + pc++);
+}
+
+uint16_t MacroInterpreter::step()
+{
+  if (!running) return 0;
+
+  /** Waits are timed in milliseconds, the poll interval changes with host sync **/
+  if (wait > 0)
+  {
+    if (millis() - waitStart < wait) return held;
+    wait = 0;
+  }
+
+  /** Execute at most one instruction per poll **/
+
+  uint8_t argument;
+  switch (fetch())
+  {
+    case OP_PRESS:
+      argument = fetch();
+      held |= argument | (fetch() << 8);
+      break;
+    case OP_RELEASE:
+      argument = fetch();
+      held &= ~(argument | (fetch() << 8));
+      break;
+    case OP_WAIT:
+      argument = fetch();
+      wait = ((uint16_t)argument * speed) >> 4;
+      waitStart = millis();
+      break;
+    case OP_LOOP:
+      argument = fetch();
+      if (depth >= MACRO_LOOP_DEPTH)
+      {
+        /** The matching OP_NEXT would end the outer loop instead **/
+        stop();
+        break;
+      }
+      loopStart[depth] = pc;
+      loopCount[depth] = argument;
+      depth += 1;
+      break;
+    case OP_NEXT:
+      if (depth > 0)
+      {
+        uint8_t top = depth - 1;
+        if (loopCount[top] == 0 || --loopCount[top] > 0) pc = loopStart[top];
+        else depth = top;
+      }
+      break;
+    case OP_JUMP:
+      pc = fetch();
+      break;
+    case OP_SPEED:
+      speed = fetch();
+      break;
+    case OP_END:
+    default:
+      stop();
+      break;
+  }
+  return held;
+}
@@ -0,0 +1,80 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef MACROINTERPRETER_H
+#define MACROINTERPRETER_H
+
+#include "Arduino.h"
+
+#define MACRO_LOOP_DEPTH      4    // maximum nesting of loops
+#define MACRO_SPEED_NORMAL    16   // speed scale of 1x (4.4 fixed point)
+
+/** OPCODES **/
+#define OP_END                0x00  // stop the macro
+#define OP_PRESS              0x01  // + 2 bytes mask: press buttons
+#define OP_RELEASE            0x02  // + 2 bytes mask: release buttons
+#define OP_WAIT               0x03  // + 1 byte: milliseconds to wait (scaled by speed)
+#define OP_LOOP               0x04  // + 1 byte: repeat until OP_NEXT n times (0 = forever)
+#define OP_NEXT               0x05  // end of loop body
+#define OP_JUMP               0x06  // + 1 byte: absolute position in program
+#define OP_SPEED              0x07  // + 1 byte: wait scale (16 = 1x, 8 = 2x faster)
+
+/** PROGRAM BUILDERS **/
+#define MACRO_END             OP_END
+#define MACRO_PRESS(mask)     OP_PRESS, (uint8_t)((mask) & 0xFF), (uint8_t)((mask) >> 8)
+#define MACRO_RELEASE(mask)   OP_RELEASE, (uint8_t)((mask) & 0xFF), (uint8_t)((mask) >> 8)
+#define MACRO_WAIT(ms)        OP_WAIT, (uint8_t)(ms)
+#define MACRO_LOOP(count)     OP_LOOP, (uint8_t)(count)
+#define MACRO_NEXT            OP_NEXT
+#define MACRO_JUMP(position)  OP_JUMP, (uint8_t)(position)
+#define MACRO_SPEED(scale)    OP_SPEED, (uint8_t)(scale)
+
+class MacroInterpreter {
+public:
+  MacroInterpreter(const uint8_t* program, uint8_t length);
+
+  void start();
+  void stop();
+  bool isRunning();
+  uint16_t step();
+
+private:
+  const uint8_t* program;
+  uint8_t length;
+  bool running;
+  uint8_t pc;
+  uint16_t wait;
+  uint32_t waitStart;
+  uint8_t speed;
+  uint16_t held;
+  uint8_t depth;
+  uint8_t loopStart[MACRO_LOOP_DEPTH];
+  uint8_t loopCount[MACRO_LOOP_DEPTH];
+
+  uint8_t fetch();
+};
+
+#endif // MACROINTERPRETER_H
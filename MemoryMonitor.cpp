@@ -0,0 +1,86 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "MemoryMonitor.h"
+#include <Arduino_DebugUtils.h>
+
+static_assert(RAM_BUDGET_CONTROLLER + RAM_BUDGET_GLOBALS + RAM_BUDGET_STACK <= RAMEND - RAMSTART + 1, "RAM budgets exceed the SRAM");
+
+extern uint8_t __data_start;
+extern uint8_t __heap_start;
+extern uint8_t* __brkval;
+
+/** Paint all RAM above .bss with the canary before main() runs **/
+void paintStack() __attribute__((naked, used, section(".init3")));
+void paintStack()
+{
+  uint8_t* p = &__heap_start;
+  while (p < (uint8_t*)SP) *p++ = STACK_CANARY;
+}
+
+static uint8_t* heapEnd()
+{
+  return __brkval ? __brkval : &__heap_start;
+}
+
+uint16_t MemoryMonitor::staticUsage()
+{
+  return &__heap_start - &__data_start;  // .data + .bss
+}
+
+uint16_t MemoryMonitor::heapUsage()
+{
+  return heapEnd() - &__heap_start;
+}
+
+uint16_t MemoryMonitor::freeMemory()
+{
+  return (uint8_t*)SP - heapEnd();
+}
+
+uint16_t MemoryMonitor::unusedStack()
+{
+  uint8_t* p = heapEnd();
+  while (p < (uint8_t*)SP && *p == STACK_CANARY) p++;
+  return p - heapEnd();
+}
+
+uint16_t MemoryMonitor::stackHighWater()
+{
+  return (RAMEND - (uint16_t)heapEnd() + 1) - unusedStack();
+}
+
+void MemoryMonitor::report()
+{
+  uint16_t unused = unusedStack();
+  DEBUG_INFO("RAM: %u bytes total", RAMEND - RAMSTART + 1);
+  DEBUG_INFO("RAM: %u bytes static (.data + .bss)", staticUsage());
+  DEBUG_INFO("RAM: %u bytes heap", heapUsage());
+  DEBUG_INFO("RAM: %u bytes free now", freeMemory());
+  DEBUG_INFO("RAM: %u bytes stack high-water, %u bytes never touched", stackHighWater(), unused);
+  if (staticUsage() + heapUsage() > RAMEND - RAMSTART + 1 - RAM_BUDGET_STACK) DEBUG_WARNING("RAM: Globals leave less than %u bytes for the stack", RAM_BUDGET_STACK);
+  if (stackHighWater() > RAM_BUDGET_STACK) DEBUG_WARNING("RAM: Stack high-water exceeds its budget of %u bytes", RAM_BUDGET_STACK);
+}
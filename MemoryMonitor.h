@@ -0,0 +1,50 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef MEMORYMONITOR_H
+#define MEMORYMONITOR_H
+
+#include "Arduino.h"
+
+#define STACK_CANARY              0xC5   // pattern painted into free RAM on boot
+
+/** RAM BUDGETS (bytes, the four parts must fit into the 2560 bytes of SRAM) **/
+#define RAM_BUDGET_RECORDER       520    // tape and state of the recorder, part of the controller
+#define RAM_BUDGET_CONTROLLER     1280   // controller object, checked at compile time
+#define RAM_BUDGET_GLOBALS        768    // USB stack, serial buffers, debug output, labels and other globals
+#define RAM_BUDGET_STACK          512    // deepest call chain: debug formatting plus nested USB interrupts
+
+class MemoryMonitor {
+public:
+  static uint16_t staticUsage();
+  static uint16_t heapUsage();
+  static uint16_t freeMemory();
+  static uint16_t stackHighWater();
+  static uint16_t unusedStack();
+  static void report();
+};
+
+#endif // MEMORYMONITOR_H
@@ -0,0 +1,56 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef OUTPUTBACKEND_H
+#define OUTPUTBACKEND_H
+
+#include "Arduino.h"
+
+/** OUTPUT BACKENDS **/
+#define OUTPUT_XINPUT           0  // Xbox 360 controller (requires XInput firmware)
+#define OUTPUT_GAMEPAD          1  // generic HID gamepad, 2 byte report
+#define OUTPUT_KEYBOARD         2  // HID keyboard, for emulators and menus
+
+#define OUTPUT_BACKEND          OUTPUT_XINPUT
+#define GAMEPAD_POLL_INTERVAL   1  // milliseconds: polling interval requested for the HID gamepad
+
+/**
+ * Every backend provides begin(), connected() and send(pad, stickX, stickY),
+ * where pad holds one bit per button id. The backend is picked at compile
+ * time, so there is no dispatch cost per poll.
+ **/
+#if OUTPUT_BACKEND == OUTPUT_GAMEPAD
+  #include "GamepadOutput.h"
+  typedef GamepadOutput OutputBackend;
+#elif OUTPUT_BACKEND == OUTPUT_KEYBOARD
+  #include "KeyboardOutput.h"
+  typedef KeyboardOutput OutputBackend;
+#else
+  #include "XInputOutput.h"
+  typedef XInputOutput OutputBackend;
+#endif
+
+#endif // OUTPUTBACKEND_H
@@ -0,0 +1,94 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "PollRateGovernor.h"
+#include <avr/sleep.h>
+
+PollRateGovernor::PollRateGovernor(uint16_t idleTimeout, uint8_t idlePollInterval)
+{
+  timeout = idleTimeout * 1000UL;
+  interval = idlePollInterval * 1000UL;
+  idle = false;
+  lastActivity = 0;
+  lastPoll = 0;
+  previousPoll = 0;
+  wakeBound = 0;
+  worstWakeBound = 0;
+}
+
+bool PollRateGovernor::isIdle()
+{
+  return idle;
+}
+
+uint32_t PollRateGovernor::lastWakeBound()
+{
+  return wakeBound;
+}
+
+uint32_t PollRateGovernor::maxWakeBound()
+{
+  return worstWakeBound;
+}
+
+void PollRateGovernor::wait()
+{
+  if (!idle) return;
+
+  /** Sleep until the next idle poll, timer and USB interrupts wake us every millisecond **/
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  uint32_t now = micros();
+  while (now - lastPoll < interval)
+  {
+    sleep_mode();
+    now = micros();
+  }
+  previousPoll = lastPoll;
+  lastPoll = now;
+}
+
+void PollRateGovernor::update(bool active)
+{
+  if (active)
+  {
+    if (idle)
+    {
+      /**
+       * The change happened after the previous idle poll at the earliest,
+       * so this is an upper bound of the latency, not a measurement.
+       **/
+      idle = false;
+      wakeBound = micros() - previousPoll;
+      if (wakeBound > worstWakeBound) worstWakeBound = wakeBound;
+    }
+    lastActivity = millis();
+  }
+  else if (!idle && millis() - lastActivity > timeout)
+  {
+    idle = true;
+    lastPoll = micros();
+  }
+}
@@ -0,0 +1,56 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef POLLRATEGOVERNOR_H
+#define POLLRATEGOVERNOR_H
+
+#include "Arduino.h"
+
+#define IDLE_TIMEOUT          60     // seconds: time without input before polling slows down
+#define IDLE_POLL_INTERVAL    8      // milliseconds: time between polls while idle
+
+class PollRateGovernor {
+public:
+  PollRateGovernor(uint16_t idleTimeout = IDLE_TIMEOUT, uint8_t idlePollInterval = IDLE_POLL_INTERVAL);
+
+  void wait();
+  void update(bool active);
+  bool isIdle();
+  uint32_t lastWakeBound();
+  uint32_t maxWakeBound();
+
+private:
+  uint32_t timeout;
+  uint32_t interval;
+  bool idle;
+  uint32_t lastActivity;
+  uint32_t lastPoll;
+  uint32_t previousPoll;
+  uint32_t wakeBound;
+  uint32_t worstWakeBound;
+};
+
+#endif // POLLRATEGOVERNOR_H
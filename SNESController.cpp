@@ -25,37 +25,16 @@
  */
 
 #include "SNESController.h"
-#include <Arduino_DebugUtils.h>
-#include <XInput.h>
 
-char* regularButtonIdentifier[] = { "B", "Y", "Select", "Start", "Up", "Down", "Left", "Right", "A", "X", "L", "R", "Logo (emulated)" };
-char* switchedButtonIdentifier[] = { "A", "Y", "Select", "Start", "Up", "Down", "Left", "Right", "B", "X", "L", "R", "Logo (emulated)" };
-
-SNESController::SNESController(int switchedAB = 1)
+template <class Features>
+SNESController<Features>::SNESController(int switchedAB) : GameConsoleController<Features>(switchedAB)
 {
-  switchAB = switchedAB;
 }
 
-void SNESController::setup()
+template <class Features>
+void SNESController<Features>::setup()
 {
-  #ifdef USB_XINPUT
-    while (!XInput.connected()) {}  // wait for connection
-
-    #ifdef LED_BUILTIN_RX
-      digitalWrite(LED_BUILTIN_RX, LOW);
-      delay(350);
-      digitalWrite(LED_BUILTIN_RX, HIGH);
-      delay(350);
-      digitalWrite(LED_BUILTIN_RX, LOW);
-      delay(350);
-      digitalWrite(LED_BUILTIN_RX, HIGH);
-      delay(350);
-      digitalWrite(LED_BUILTIN_RX, LOW);
-    #endif
-  #endif
-  
-  XInput.setAutoSend(false);
-  XInput.begin();
+  GameConsoleController<Features>::setup();
 
   // Setup NES / SNES latch and clock pins (2/3 or PD1/PD0)
   DDRD  |=  B00000011; // output
@@ -77,7 +56,8 @@ void SNESController::setup()
   pinMode (DATA_SERIAL, INPUT_PULLUP);  
 }
 
-void SNESController::sendLatch()
+template <class Features>
+void SNESController<Features>::sendLatch()
 {
   digitalWrite(DATA_LATCH, HIGH);
   __builtin_avr_delay_cycles(192);
@@ -85,7 +65,8 @@ void SNESController::sendLatch()
   __builtin_avr_delay_cycles(72);
 }
 
-void SNESController::sendClock()
+template <class Features>
+void SNESController<Features>::sendClock()
 {
   digitalWrite(DATA_CLOCK, HIGH); 
   __builtin_avr_delay_cycles(96);
@@ -93,235 +74,31 @@ void SNESController::sendClock()
   __builtin_avr_delay_cycles(72);
 }
 
-void SNESController::preFetch()
-{
-  #ifdef LED_BUILTIN_RX && LED_BUILTIN_TX
-    digitalWrite(LED_BUILTIN_RX, !recorder.isRecording() ? HIGH : LOW);
-    digitalWrite(LED_BUILTIN_TX, !deactivated ? HIGH : LOW);
-  #endif
-}
-
-void SNESController::fetch()
+template <class Features>
+void SNESController<Features>::fetch()
 {
   /** Latch for 12us **/
   sendLatch();
 
-  /** Read data bit by bit from SR **/
+  /** Read data bit by bit from SR (set bit = line low = pressed) **/
+  uint16_t raw = 0;
   for (int id = 0; id < 16; id++) {
-    if (id < SNES_BTN_NUM) {
-      button[id].updateInput(!digitalRead(DATA_SERIAL));
-      if (button[id].changed && !deactivated && recorder.isIdle())
-      {
-        char* buttonLabel = switchAB ? switchedButtonIdentifier[id] : regularButtonIdentifier[id];
-        DEBUG_DEBUG("%s Pressed: %i", buttonLabel, button[id].pressed);
-        DEBUG_DEBUG("%s Released: %i", buttonLabel, button[id].released);
-        //DEBUG_DEBUG("%s Held: %i", buttonLabel, button[id].held);
-        DEBUG_DEBUG("%s Duration: %i", buttonLabel, button[id].duration);
-        DEBUG_DEBUG("%s Clicks: %i", buttonLabel, button[id].clicks);
-      }
-    }
+    if (!digitalRead(DATA_SERIAL)) raw |= bit(id);
     sendClock();
   }
-}
-
-void SNESController::postFetch()
-{
-  if (emulateLogoButton() || deactivated) return;
-
-  if (!handleDeactivation())
-    if (!handleAutoFire())
-      if (!handleRecording())
-        return;
-}
-
-bool SNESController::emulateLogoButton() {
-  if (button[EMU_LOGO_BUTTON1].held && button[EMU_LOGO_BUTTON2].held)
-  {
-    button[SNES_EMU_LOGO].updateInput(true);
-    return false;
-  }
-  button[SNES_EMU_LOGO].updateInput(false);
-  return false;
-}
-
-bool SNESController::handleDeactivation() {
-  int duration = DEACTIVATION_BUTTON_TIME * 1000;
-  if (button[DEACTIVATION_BUTTON].duration > duration && button[DEACTIVATION_BUTTON].held)
-  {
-    int time_window_after_boot = DEACTIVATION_TIME_WINDOW * 1000;
-    if (millis() < time_window_after_boot)
-    {
-      button[DEACTIVATION_BUTTON].reset();
-      deactivated = true;
-
-      DEBUG_WARNING("Modifications disabled until power reset");
-      if (Debug.getDebugLevel() > -1) Debug.setDebugLevel(DBG_ERROR);
-      return true;
-    }
-    else DEBUG_WARNING("Disabling of modifications only possible within the first %i seconds", time_window_after_boot);
-  }
-  return false;
-}
-
-bool SNESController::handleAutoFire() {
-  int autoFireButtons[] = { SNES_A, SNES_B, SNES_X, SNES_Y, SNES_L, SNES_R };
-  for (int id = 0; id < 6; ++id)
-  {
-    int autoFire = autoFireButtons[id];
-    if (button[AUTOFIRE_BUTTON].held && button[autoFire].released)
-    {
-      button[autoFire].toggleMode();
-      switch (button[autoFire].mode)
-      {
-      case MODE_NORMAL:
-        DEBUG_INFO("%s Auto-Fire: Disabled", regularButtonIdentifier[autoFire]);
-        break;
-      case MODE_AUTOFIRE:
-        DEBUG_INFO("%s Auto-Fire: Enabled", regularButtonIdentifier[autoFire]);
-        break;
-      }
-      return true;
-    }
-  }
-  return false;
-}
-
-bool SNESController::handleRecording() {
-  int duration = CONTINUOUS_BUTTON_TIME * 1000;
-  bool startRecording = button[PROGRAM_BUTTON].released && button[PROGRAM_BUTTON].clicks == PROGRAM_BUTTON_REC_CLICKS;
-  if (recorder.isIdle())
-  {
-    if (startRecording)
-    {
-      recorder.startRecording();
-      DEBUG_DEBUG("Recording: Started");
-      return true;
-    }
-    else if (button[PROGRAM_BUTTON].released && button[PROGRAM_BUTTON].clicks == PROGRAM_BUTTON_PLAY_CLICKS && recorder.hasRecord() && button[PROGRAM_BUTTON].duration < MULTICLICK_TIMEOUT)
-    {
-      recorder.startPlayback();
-      DEBUG_DEBUG("Playback: Started");
-      return true;
-    }
-    else if (recorder.continuousPlayback && button[PROGRAM_BUTTON].held) 
-    {
-      recorder.startPlayback();
-      DEBUG_DEBUG("Continuous Playback: Looped");
-      return true;
-    }
-  }
-  else if (recorder.isRecording())
-  {
-    if (button[PROGRAM_BUTTON].released && button[PROGRAM_BUTTON].clicks == PROGRAM_BUTTON_SAVE_CLICKS)
-    {
-      recorder.endRecording();
-      recorder.continuousPlayback = false;
-
-      int recordedButtons = recorder.countRecords();
-      if (recordedButtons > 0) DEBUG_INFO("Recording: Finished (%i Buttonpresses saved)", recordedButtons);
-      else DEBUG_DEBUG("Recording: Aborted");
-
-      return true;
-    }
-    else if (button[PROGRAM_BUTTON].held && button[PROGRAM_BUTTON].duration > duration) 
-    {
-      recorder.endRecording();
-      recorder.continuousPlayback = true;
-
-      int recordedButtons = recorder.countRecords();
-      if (recordedButtons > 0) DEBUG_INFO("Recording: Finished (%i Buttonpresses saved), Continuous Playback", recordedButtons);
-      else DEBUG_DEBUG("Recording: Aborted");
-
-      return true;
-    }
-  }
-  else if (recorder.continuousPlayback && recorder.hasRecord() && startRecording)
-  {
-      recorder.startRecording();
-      DEBUG_DEBUG("Recording: Started");
-  }
-  return false;
-}
-
-ControllerButton SNESController::get(int id)
-{
-  return button[id];
-}
 
-void SNESController::set(int id, ControllerButton buttonUpdate)
-{
-  button[id] = buttonUpdate;
-}
-
-void SNESController::preSubmit()
-{
-  int forcePlaybackButton = recorder.playback();
-  for (int id = 0; id < SNES_BTN_NUM + 1; ++id)
-  {
-    bool emulatingLogoButton = button[SNES_EMU_LOGO].held && (id == EMU_LOGO_BUTTON1 || id == EMU_LOGO_BUTTON2);
-    bool skipProgramButton = recorder.countRecords() > 0 && button[PROGRAM_BUTTON].held && id == PROGRAM_BUTTON;
-    if (emulatingLogoButton || skipProgramButton)
-    {
-        button[id].ignore();
-    }
-    else 
-    {
-      button[id].process();
-      if (recorder.isRecording())
-      {
-        if (button[id].pressed && id != PROGRAM_BUTTON) 
-        {
-          if (recorder.record(id)) DEBUG_DEBUG("%s Recording", regularButtonIdentifier[id]);
-          else DEBUG_ERROR("%s Recording: FAILED", regularButtonIdentifier[id]);
-        }
-        button[id].ignore();
-      }
-      else if (forcePlaybackButton > -1)
-      {
-        if (id == forcePlaybackButton)
-        {
-          DEBUG_DEBUG("%s Playback", regularButtonIdentifier[id]);
-          button[id].fire();
-        }
-        else button[id].ignore();
-      }
-    }
-  }
+  /**
+   * A pad shifts in low bits after its 16 bits, while an open line is pulled
+   * high. A real pad also never reports its ID bits as pressed, which rules
+   * out a shorted data line.
+   **/
+  bool present = !digitalRead(DATA_SERIAL) && !(raw & SNES_ID_BITS);
+
+  /** A read without a pad (or a half inserted one) counts as all released right away **/
+  if (!present) raw = 0;
+  this->detectPad(present);
+  this->updateButtons(raw);
 }
 
-void SNESController::submit()
-{
-  XInput.releaseAll();
-
-  XInput.setButton(BUTTON_LOGO,      button[SNES_EMU_LOGO].output     );
-
-  XInput.setButton(BUTTON_A,      button[switchAB ? SNES_A : SNES_B].output     );
-  XInput.setButton(BUTTON_B,      button[switchAB ? SNES_B : SNES_A].output     );
-  XInput.setButton(BUTTON_BACK,   button[SNES_SELECT].output);
-  XInput.setButton(BUTTON_START,  button[SNES_START].output );
-
-  XInput.setDpad(
-    button[SNES_UP].output, 
-    button[SNES_DOWN].output, 
-    button[SNES_LEFT].output, 
-    button[SNES_RIGHT].output,
-    true
-  );
-
-  XInput.setButton(BUTTON_X,      button[SNES_X].output     );
-  XInput.setButton(BUTTON_Y,      button[SNES_Y].output     );
-  XInput.setButton(BUTTON_LB,     button[SNES_L].output     );
-  XInput.setButton(BUTTON_RB,     button[SNES_R].output     );
-
-  #ifdef USB_XINPUT
-    XInput.send(); 
-  #else 
-    for (int id = 0; id < SNES_BTN_NUM + 1; ++id)
-    {
-      if (button[id].held && recorder.isIdle() && !recorder.isRecording())
-      {
-          DEBUG_INFO("%s (%s)", switchAB ? switchedButtonIdentifier[id] : regularButtonIdentifier[id], button[id].output ? "*" : " ");      
-      }
-    }
-  #endif
-}
\ No newline at end of file
+template class SNESController<FullFeatures>;
+template class SNESController<PassthroughFeatures>;
@@ -0,0 +1,77 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "SOCDResolver.h"
+
+SOCDResolver::SOCDResolver(int socdMode)
+{
+  mode = socdMode;
+  reset();
+}
+
+void SOCDResolver::reset()
+{
+  previous = 0;
+  winner = 0;
+}
+
+uint8_t SOCDResolver::resolve(uint8_t dpad)
+{
+  uint8_t fresh = dpad & ~previous;
+  previous = dpad;
+
+  /** Remember the direction that is held alone on each axis **/
+  uint8_t vertical = dpad & DIR_VERTICAL;
+  uint8_t horizontal = dpad & DIR_HORIZONTAL;
+  if (vertical != DIR_VERTICAL) winner = (winner & DIR_HORIZONTAL) | vertical;
+  if (horizontal != DIR_HORIZONTAL) winner = (winner & DIR_VERTICAL) | horizontal;
+
+  /** Nothing to resolve without opposing directions **/
+  if (vertical != DIR_VERTICAL && horizontal != DIR_HORIZONTAL) return dpad;
+
+  switch (mode)
+  {
+    case SOCD_LAST_INPUT:
+      /** A single freshly pressed direction takes over its axis **/
+      if ((fresh & DIR_VERTICAL) && (fresh & DIR_VERTICAL) != DIR_VERTICAL)
+        winner = (winner & DIR_HORIZONTAL) | (fresh & DIR_VERTICAL);
+      if ((fresh & DIR_HORIZONTAL) && (fresh & DIR_HORIZONTAL) != DIR_HORIZONTAL)
+        winner = (winner & DIR_VERTICAL) | (fresh & DIR_HORIZONTAL);
+      return winner;
+    case SOCD_FIRST_INPUT:
+      /** Winner keeps the direction held before the opposing one arrived **/
+      return winner;
+    case SOCD_UP_PRIORITY:
+      if (vertical == DIR_VERTICAL) vertical = DIR_UP;
+      if (horizontal == DIR_HORIZONTAL) horizontal = 0;
+      return vertical | horizontal;
+    case SOCD_NEUTRAL:
+    default:
+      if (vertical == DIR_VERTICAL) vertical = 0;
+      if (horizontal == DIR_HORIZONTAL) horizontal = 0;
+      return vertical | horizontal;
+  }
+}
@@ -0,0 +1,59 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef SOCDRESOLVER_H
+#define SOCDRESOLVER_H
+
+#include "Arduino.h"
+
+/** D-PAD MASK (bit order of SNES_UP..SNES_RIGHT) **/
+#define DIR_UP                0x01
+#define DIR_DOWN              0x02
+#define DIR_LEFT              0x04
+#define DIR_RIGHT             0x08
+#define DIR_VERTICAL          (DIR_UP | DIR_DOWN)
+#define DIR_HORIZONTAL        (DIR_LEFT | DIR_RIGHT)
+
+/** SOCD MODES **/
+#define SOCD_NEUTRAL          0  // opposing directions cancel each other
+#define SOCD_LAST_INPUT       1  // most recently pressed direction wins
+#define SOCD_FIRST_INPUT      2  // direction pressed first wins
+#define SOCD_UP_PRIORITY      3  // up wins vertically, horizontal cancels
+
+class SOCDResolver {
+public:
+  int mode;
+
+  SOCDResolver(int socdMode = SOCD_NEUTRAL);
+  uint8_t resolve(uint8_t dpad);
+  void reset();
+
+private:
+  uint8_t previous;
+  uint8_t winner;
+};
+
+#endif // SOCDRESOLVER_H
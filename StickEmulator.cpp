@@ -0,0 +1,85 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "StickEmulator.h"
+
+/** Stick deflection per ramp step, cardinal and diagonal (scaled by 1/sqrt(2)) **/
+const int16_t stickCurves[STICK_CURVE_NUM][2][STICK_CURVE_STEPS] PROGMEM = {
+  { /** STICK_CURVE_INSTANT **/
+    { 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767 },
+    { 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170, 23170 }
+  },
+  { /** STICK_CURVE_LINEAR **/
+    {  2048,  4096,  6144,  8192, 10240, 12288, 14336, 16384, 18431, 20479, 22527, 24575, 26623, 28671, 30719, 32767 },
+    {  1448,  2896,  4344,  5793,  7241,  8689, 10137, 11585, 13033, 14481, 15929, 17377, 18825, 20273, 21722, 23170 }
+  },
+  { /** STICK_CURVE_QUADRATIC **/
+    {   128,   512,  1152,  2048,  3200,  4608,  6272,  8192, 10368, 12800, 15488, 18431, 21631, 25087, 28799, 32767 },
+    {    91,   362,   815,  1448,  2263,  3258,  4435,  5793,  7331,  9051, 10952, 13033, 15295, 17739, 20364, 23170 }
+  }
+};
+
+StickEmulator::StickEmulator(int stickCurve, uint8_t stepTime)
+{
+  curve = stickCurve;
+  rampTime = stepTime;
+  reset();
+}
+
+void StickEmulator::reset()
+{
+  direction = 0;
+  ramp = 0;
+  stepAt = 0;
+  x = 0;
+  y = 0;
+}
+
+void StickEmulator::update(uint8_t dpad)
+{
+  if (dpad != direction)
+  {
+    /** Keep the ramp when a direction is added or dropped, restart it otherwise **/
+    if (!(dpad & direction))
+    {
+      ramp = 0;
+      stepAt = millis();
+    }
+    direction = dpad;
+  }
+  else if (dpad && ramp < STICK_CURVE_STEPS - 1 && millis() - stepAt >= rampTime)
+  {
+    /** Timed in milliseconds, the poll interval changes with host sync and idle polling **/
+    stepAt += rampTime;
+    ramp += 1;
+  }
+
+  bool diagonal = (dpad & DIR_VERTICAL) && (dpad & DIR_HORIZONTAL);
+  int16_t value = pgm_read_word(&stickCurves[curve][diagonal][ramp]);
+
+  x = (dpad & DIR_RIGHT) ? value : (dpad & DIR_LEFT) ? -value : 0;
+  y = (dpad & DIR_UP)    ? value : (dpad & DIR_DOWN) ? -value : 0;
+}
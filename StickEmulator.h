@@ -0,0 +1,61 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#ifndef STICKEMULATOR_H
+#define STICKEMULATOR_H
+
+#include "Arduino.h"
+#include "SOCDResolver.h"
+
+/** STICK EMULATION MODES **/
+#define STICK_OFF             0  // d-pad is sent as d-pad
+#define STICK_LEFT            1  // d-pad drives the left analog stick
+
+/** RESPONSE CURVES **/
+#define STICK_CURVE_INSTANT   0  // full deflection immediately
+#define STICK_CURVE_LINEAR    1  // linear ramp-up
+#define STICK_CURVE_QUADRATIC 2  // slow start, fast finish
+#define STICK_CURVE_NUM       3
+#define STICK_CURVE_STEPS     16
+
+class StickEmulator {
+public:
+  int curve;
+  uint8_t rampTime;
+  int16_t x;
+  int16_t y;
+
+  StickEmulator(int stickCurve = STICK_CURVE_LINEAR, uint8_t stepTime = 8);
+  void update(uint8_t dpad);
+  void reset();
+
+private:
+  uint8_t direction;
+  uint8_t ramp;
+  uint32_t stepAt;
+};
+
+#endif // STICKEMULATOR_H
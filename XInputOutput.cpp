@@ -0,0 +1,77 @@
+/*
+ * 
+ *  MIT License
+ * 
+ *  (C) Copyright 2024 Tim Böttiger
+ * 
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to 
+ *  deal in the Software without restriction, including without limitation the 
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ * 
+ *  The above copyright notice and this permission notice shall be included in 
+ *  all copies or substantial portions of the Software.
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+ *  DEALINGS IN THE SOFTWARE.
+ *  
+ */
+
+#include "GameConsoleController.h"
+
+#if OUTPUT_BACKEND == OUTPUT_XINPUT
+
+#include <XInput.h>
+
+void XInputOutput::begin()
+{
+  XInput.setAutoSend(false);
+  XInput.begin();
+}
+
+bool XInputOutput::connected()
+{
+  return XInput.connected();
+}
+
+void XInputOutput::send(uint16_t pad, int16_t stickX, int16_t stickY)
+{
+  XInput.setButton(BUTTON_LOGO,   pad & bit(SNES_EMU_LOGO));
+
+  XInput.setButton(BUTTON_A,      pad & bit(SNES_B)     );
+  XInput.setButton(BUTTON_B,      pad & bit(SNES_A)     );
+  XInput.setButton(BUTTON_BACK,   pad & bit(SNES_SELECT));
+  XInput.setButton(BUTTON_START,  pad & bit(SNES_START) );
+
+  XInput.setDpad(
+    pad & bit(SNES_UP),
+    pad & bit(SNES_DOWN),
+    pad & bit(SNES_LEFT),
+    pad & bit(SNES_RIGHT),
+    false   // SOCD already resolved
+  );
+  XInput.setJoystick(JOY_LEFT, stickX, stickY);
+
+  XInput.setButton(BUTTON_X,      pad & bit(SNES_X)     );
+  XInput.setButton(BUTTON_Y,      pad & bit(SNES_Y)     );
+  XInput.setButton(BUTTON_LB,     pad & bit(SNES_L)     );
+  XInput.setButton(BUTTON_RB,     pad & bit(SNES_R)     );
+
+  /**
+   * Only queues a report if the state changed. The host poll tracker
+   * counts the schedule in USB frames, so it does not need a report in
+   * every host frame to stay in phase.
+   **/
+  #ifdef USB_XINPUT
+    XInput.send();
+  #endif
+}
+
+#endif
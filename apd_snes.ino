@@ -25,7 +25,12 @@
  */
 
 #include <Arduino_DebugUtils.h>
+#include <EEPROM.h>
 #include "SNESController.h"
+#include "GenesisController.h"
+#include "HostPollTracker.h"
+#include "MemoryMonitor.h"
+#include "PollRateGovernor.h"
 
 //                     DBG_NONE
 //                     DBG_VERBOSE
@@ -34,11 +39,69 @@
 #define REGULAR_AB     0    
 #define SWITCH_AB      1
 
-SNESController snesController = SNESController(REGULAR_AB);
+#define CONSOLE_SNES     0
+#define CONSOLE_GENESIS  1
+#define CONSOLE          CONSOLE_SNES
+
+#define FEATURES         FullFeatures   // PassthroughFeatures: read -> map -> send only
+
+#define HOST_POLL_SYNC    true   // sample the pad just before the host collects the report
+#define ADAPTIVE_POLLING  true   // poll less often after IDLE_TIMEOUT seconds without input
+
+#define POLL_PROFILE        false  // time the polls of the XInput build and store the result in EEPROM
+#define POLL_PROFILE_POLLS  10000  // polls to time before the result is stored
+#define POLL_PROFILE_ADDR   0      // EEPROM address of the stored result
+
+#if CONSOLE == CONSOLE_GENESIS
+  GenesisController<FEATURES> controller = GenesisController<FEATURES>(REGULAR_AB);
+#else
+  SNESController<FEATURES> controller = SNESController<FEATURES>(REGULAR_AB);
+#endif
+HostPollTracker hostPoll;
+PollRateGovernor pollRate;
+
+struct PollProfile {
+  uint32_t polls;
+  uint32_t time;      // microseconds, all polls
+  uint16_t longest;   // microseconds
+};
+PollProfile profile = { 0, 0, 0 };
+
+void reportMemory()
+{
+  MemoryMonitor::report();
+  controller.reportMemory();
+  DEBUG_INFO("RAM: %u bytes host poll tracker", sizeof(hostPoll));
+  DEBUG_INFO("RAM: %u bytes poll rate governor", sizeof(pollRate));
+}
+
+void profilePoll(uint16_t duration)
+{
+  if (profile.polls >= POLL_PROFILE_POLLS) return;
+  profile.polls += 1;
+  profile.time += duration;
+  if (duration > profile.longest) profile.longest = duration;
+
+  /** The XInput build has no serial port, the debug build reads the result back **/
+  if (profile.polls == POLL_PROFILE_POLLS) EEPROM.put(POLL_PROFILE_ADDR, profile);
+}
+
+void reportPollProfile()
+{
+  PollProfile stored;
+  EEPROM.get(POLL_PROFILE_ADDR, stored);
+  if (stored.polls == 0 || stored.polls == 0xFFFFFFFF)
+  {
+    DEBUG_INFO("Poll: No profile stored");
+    return;
+  }
+  uint32_t average = stored.time / stored.polls;
+  DEBUG_INFO("Poll: %lu us / %lu cycles on average, %u us longest, over %lu polls", average, average * (F_CPU / 1000000UL), stored.longest, stored.polls);
+}
 
 void setup() 
 {
-  snesController.setup();
+  controller.setup();
 
   #ifndef USB_XINPUT
     Serial.begin(115200);
@@ -46,16 +109,55 @@ void setup()
     Debug.timestampOn();
     Debug.setDebugLevel(DEBUG_LEVEL);
 
-    while (!Serial) {}  // wait for connection
     DEBUG_VERBOSE("It's-a me, %s!", "Mario");
+    reportMemory();
   #endif
 }
 
 void loop()
 {
-  snesController.preFetch();
-  snesController.fetch();
-  snesController.postFetch();
-  snesController.preSubmit();
-  snesController.submit();
+  if (ADAPTIVE_POLLING) pollRate.wait();
+  if (HOST_POLL_SYNC)
+  {
+    bool wasLocked = hostPoll.isLocked();
+    hostPoll.waitForSlot();
+    if (hostPoll.isLocked() != wasLocked)
+    {
+      if (wasLocked) DEBUG_VERBOSE("Host poll: Unlocked");
+      else DEBUG_VERBOSE("Host poll: Locked, every %lu us, sampling %u us ahead", hostPoll.interval(), hostPoll.leadTime());
+    }
+  }
+
+  #ifdef USB_XINPUT
+    uint32_t pollStart = POLL_PROFILE ? micros() : 0;
+  #endif
+
+  controller.preFetch();
+  controller.fetch();
+  controller.postFetch();
+  controller.preSubmit();
+  controller.submit();
+
+  #ifdef USB_XINPUT
+    if (POLL_PROFILE && controller.isHostConnected()) profilePoll(micros() - pollStart);
+  #endif
+
+  if (HOST_POLL_SYNC && controller.isHostConnected()) hostPoll.sent();
+  if (ADAPTIVE_POLLING)
+  {
+    bool wasIdle = pollRate.isIdle();
+    pollRate.update(controller.isActive());
+    if (wasIdle && !pollRate.isIdle()) DEBUG_VERBOSE("Wake-up: change seen within %lu us (worst %lu us)", pollRate.lastWakeBound(), pollRate.maxWakeBound());
+  }
+
+  #ifndef USB_XINPUT
+    if (Serial.available())
+    {
+      switch (Serial.read())
+      {
+        case 'm': reportMemory(); break;
+        case 'p': reportPollProfile(); break;
+      }
+    }
+  #endif
 }